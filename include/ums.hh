@@ -6,6 +6,14 @@
 #include <vector>
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <complex>
+#include <cstdint>
+#include <numbers>
+#include <ranges>
+#include <unordered_map>
 
 namespace ums {
 
@@ -127,6 +135,239 @@ concept VectorLike = requires(T& vec) {
     { len(vec) } -> std::convertible_to<size_t>;
 };
 
+// Define a concept for storage whose `data()` outlives the expression that produced it:
+// references to containers, or views such as `std::span`
+template <typename T>
+concept BorrowedStorage = std::is_lvalue_reference_v<T> || std::ranges::borrowed_range<T>;
+
+// Define a concept for sparse index element types: integers, but not `bool` or character types
+template <typename T>
+concept SparseIndex = std::integral<T> && !std::same_as<T, bool> && !std::same_as<T, char> &&
+    !std::same_as<T, wchar_t> && !std::same_as<T, char8_t> && !std::same_as<T, char16_t> &&
+    !std::same_as<T, char32_t>;
+
+// Define a concept for Sparse-vector-like types: sorted (index, value) storage, such as
+// `Eigen::SparseVector`, a row of a row-major `Eigen::SparseMatrix`, a type exposing
+// `indices()` and `values()`, or a pair of index and value arrays (e.g. two `std::span`s).
+// Eigen types must be vectors at compile time, so whole matrices and multi-row blocks are rejected.
+template <typename T>
+concept SparseVectorLike =
+    requires(const T& vec) {
+        vec.innerIndexPtr(); vec.valuePtr(); vec.outerIndexPtr(); vec.nonZeros(); vec.size();
+        requires bool(T::IsVectorAtCompileTime);
+    } ||
+    requires(const T& vec) {
+        vec.indices().data(); vec.values().data(); vec.indices().size(); vec.values().size();
+        requires BorrowedStorage<decltype(vec.indices())> && BorrowedStorage<decltype(vec.values())>;
+        requires SparseIndex<std::remove_cvref_t<decltype(*vec.indices().data())>>;
+        requires Arithmetic<std::remove_cvref_t<decltype(*vec.values().data())>>;
+    } ||
+    requires(const T& vec) {
+        vec.first.data(); vec.second.data(); vec.first.size(); vec.second.size();
+        requires SparseIndex<std::remove_cvref_t<decltype(*vec.first.data())>>;
+        requires Arithmetic<std::remove_cvref_t<decltype(*vec.second.data())>>;
+    };
+
+// Define a concept for types that are either Sparse-vector-like or Vector-like
+template <typename T>
+concept AnyVectorLike = SparseVectorLike<T> || VectorLike<T>;
+
+// Dimension of sparse storage that does not carry one, such as a pair of spans
+inline constexpr size_t unknown_dimension = static_cast<size_t>(-1);
+
+// Non-owning view of the non-zeros of a Sparse-vector-like type, sorted by index
+template <typename INDEX, typename VALUE>
+struct sparse_view {
+    const INDEX* indices;
+    const VALUE* values;
+    size_t nnz;
+    size_t size;
+};
+
+template <typename INDEX, typename VALUE>
+sparse_view<INDEX, VALUE> make_sparse_view(const INDEX* indices, const VALUE* values, size_t nnz, size_t size) {
+    return {indices, values, nnz, size};
+}
+
+template <typename INDICES, typename VALUES>
+auto make_sparse_view(const INDICES& indices, const VALUES& values) {
+    if (indices.size() != values.size()) {
+        throw std::length_error("Sparse indices and values must have the same length.");
+    }
+    return make_sparse_view(indices.data(), values.data(), indices.size(), unknown_dimension);
+}
+
+// Define the `nonzeros` function that works with any Sparse-vector-like type
+template <SparseVectorLike T>
+auto nonzeros(const T& vec) {
+    if constexpr (requires { vec.innerIndexPtr(); vec.outerIndexPtr(); }) {
+        // Eigen sparse vectors have no outer index; an inner slice of a matrix starts at its outer index.
+        size_t start = vec.outerIndexPtr() ? vec.outerIndexPtr()[0] : 0;
+        return make_sparse_view(vec.innerIndexPtr() + start, vec.valuePtr() + start,
+                                static_cast<size_t>(vec.nonZeros()), static_cast<size_t>(vec.size()));
+    } else if constexpr (requires { vec.indices(); vec.values(); }) {
+        return make_sparse_view(vec.indices(), vec.values());
+    } else {
+        return make_sparse_view(vec.first, vec.second);
+    }
+}
+
+// Throw unless a sparse vector fits a dimension of `n`, which may itself be unknown
+template <typename INDEX, typename VALUE>
+void check_dimension(const sparse_view<INDEX, VALUE>& a, size_t n) {
+    if constexpr (std::is_signed_v<INDEX>) {
+        if (a.nnz > 0 && a.indices[0] < 0) {
+            throw std::out_of_range("Sparse index must not be negative.");
+        }
+    }
+    if (n == unknown_dimension) {
+        return;
+    }
+    if (a.size != unknown_dimension) {
+        if (a.size != n) {
+            throw std::length_error("Arrays must have the same length.");
+        }
+    } else if (a.nnz > 0 && static_cast<size_t>(a.indices[a.nnz - 1]) >= n) {
+        throw std::out_of_range("Sparse index exceeds the vector length.");
+    }
+}
+
+// Position of the first of `indices[begin, end)` not below `target`. Probes exponentially
+// from `begin`, then binary searches the bracketed range.
+template <typename INDEX>
+size_t gallop(const INDEX* indices, size_t begin, size_t end, size_t target) {
+    size_t hi = begin;
+    size_t step = 1;
+    while (hi < end && static_cast<size_t>(indices[hi]) < target) {
+        begin = hi + 1;
+        hi += step;
+        step *= 2;
+    }
+    hi = std::min(hi, end);
+    auto below = [](const INDEX& index, size_t value) { return static_cast<size_t>(index) < value; };
+    return std::lower_bound(indices + begin, indices + hi, target, below) - indices;
+}
+
+// Galloping pays off once searching the longer list is cheaper than walking it
+inline bool prefer_galloping(size_t small, size_t large) {
+    return small * static_cast<size_t>(std::bit_width(large)) < large;
+}
+
+template <typename IS, typename VS, typename IL, typename VL, typename RESULT>
+void galloping_dot(const sparse_view<IS, VS>& small, const sparse_view<IL, VL>& large, RESULT& result) {
+    size_t j = 0;
+    for (size_t i = 0; i < small.nnz && j < large.nnz; ++i) {
+        size_t target = small.indices[i];
+        j = gallop(large.indices, j, large.nnz, target);
+        if (j < large.nnz && static_cast<size_t>(large.indices[j]) == target) {
+            result += static_cast<RESULT>(small.values[i]) * static_cast<RESULT>(large.values[j]);
+            ++j;
+        }
+    }
+}
+
+// Sparse-sparse dot product over the intersection of the index lists
+template <typename IA, typename VA, typename IB, typename VB>
+auto sparse_dot(const sparse_view<IA, VA>& a, const sparse_view<IB, VB>& b) {
+    using CommonType = std::common_type_t<VA, VB>;
+
+    check_dimension(a, b.size);
+    check_dimension(b, a.size);
+    CommonType result = 0;
+    if (prefer_galloping(a.nnz, b.nnz)) {
+        galloping_dot(a, b, result);
+    } else if (prefer_galloping(b.nnz, a.nnz)) {
+        galloping_dot(b, a, result);
+    } else {
+        size_t i = 0;
+        size_t j = 0;
+        while (i < a.nnz && j < b.nnz) {
+            size_t ia = a.indices[i];
+            size_t ib = b.indices[j];
+            if (ia == ib) {
+                result += static_cast<CommonType>(a.values[i++]) * static_cast<CommonType>(b.values[j++]);
+            } else if (ia < ib) {
+                ++i;
+            } else {
+                ++j;
+            }
+        }
+    }
+    return result;
+}
+
+// Sparse-dense dot product, gathering the dense entries at the sparse indices
+template <typename INDEX, typename VALUE, VectorLike B>
+auto sparse_dense_dot(const sparse_view<INDEX, VALUE>& a, const B& b) {
+    using ValueTypeB = std::remove_reference_t<decltype(at(b, 0))>;
+    using CommonType = std::common_type_t<VALUE, ValueTypeB>;
+
+    check_dimension(a, len(b));
+    CommonType result = 0;
+    for (size_t k = 0; k < a.nnz; ++k) {
+        result += static_cast<CommonType>(a.values[k]) * static_cast<CommonType>(at(b, a.indices[k]));
+    }
+    return result;
+}
+
+template <typename INDEX, typename VALUE>
+auto sparse_l2(const sparse_view<INDEX, VALUE>& a) {
+    using SumType = std::common_type_t<VALUE, double>;
+
+    SumType result = 0;
+    for (size_t k = 0; k < a.nnz; ++k) {
+        auto value = static_cast<SumType>(a.values[k]);
+        result += value * value;
+    }
+    return std::sqrt(result);
+}
+
+// Sparse-sparse Euclidean distance over the union of the index lists
+template <typename IA, typename VA, typename IB, typename VB>
+auto sparse_euclidean_distance(const sparse_view<IA, VA>& a, const sparse_view<IB, VB>& b) {
+    using CommonType = std::common_type_t<VA, VB>;
+
+    check_dimension(a, b.size);
+    check_dimension(b, a.size);
+    CommonType result = 0;
+    size_t i = 0;
+    size_t j = 0;
+    while (i < a.nnz || j < b.nnz) {
+        size_t ia = i < a.nnz ? static_cast<size_t>(a.indices[i]) : unknown_dimension;
+        size_t ib = j < b.nnz ? static_cast<size_t>(b.indices[j]) : unknown_dimension;
+        CommonType diff;
+        if (ia == ib) {
+            diff = static_cast<CommonType>(a.values[i++]) - static_cast<CommonType>(b.values[j++]);
+        } else if (ia < ib) {
+            diff = static_cast<CommonType>(a.values[i++]);
+        } else {
+            diff = static_cast<CommonType>(b.values[j++]);
+        }
+        result += diff * diff;
+    }
+    return std::sqrt(result);
+}
+
+// Sparse-dense Euclidean distance, walking the dense vector once
+template <typename INDEX, typename VALUE, VectorLike B>
+auto sparse_dense_euclidean_distance(const sparse_view<INDEX, VALUE>& a, const B& b) {
+    using ValueTypeB = std::remove_reference_t<decltype(at(b, 0))>;
+    using CommonType = std::common_type_t<VALUE, ValueTypeB>;
+
+    size_t n = len(b);
+    check_dimension(a, n);
+    CommonType result = 0;
+    size_t k = 0;
+    for (size_t i = 0; i < n; ++i) {
+        auto diff = static_cast<CommonType>(at(b, i));
+        if (k < a.nnz && static_cast<size_t>(a.indices[k]) == i) {
+            diff = static_cast<CommonType>(a.values[k++]) - diff;
+        }
+        result += diff * diff;
+    }
+    return std::sqrt(result);
+}
+
 // Define the `dot` function for two Array-like types
 template <VectorLike A, VectorLike B, typename INDEX>
 auto dot(const A& a, const B& b, INDEX begin, INDEX count) {
@@ -141,14 +382,22 @@ auto dot(const A& a, const B& b, INDEX begin, INDEX count) {
     return result;
 }
 
-// Define the `dot` function for two Array-like types
-template <VectorLike A, VectorLike B>
+// Define the `dot` function for two Array-like types, either of which may be sparse
+template <AnyVectorLike A, AnyVectorLike B>
 auto dot(const A& a, const B& b) {
-    auto n = len(a);
-    if (n != len(b)) {
-        throw std::length_error("Arrays must have the same length.");
+    if constexpr (SparseVectorLike<A> && SparseVectorLike<B>) {
+        return sparse_dot(nonzeros(a), nonzeros(b));
+    } else if constexpr (SparseVectorLike<A>) {
+        return sparse_dense_dot(nonzeros(a), b);
+    } else if constexpr (SparseVectorLike<B>) {
+        return sparse_dense_dot(nonzeros(b), a);
+    } else {
+        auto n = len(a);
+        if (n != len(b)) {
+            throw std::length_error("Arrays must have the same length.");
+        }
+        return dot(a, b, static_cast<decltype(n)>(0), n);
     }
-    return dot(a, b, static_cast<decltype(n)>(0), n);
 }
 
 // Define the `sum` function for an Array-like type
@@ -281,10 +530,14 @@ auto l2(const A& a, INDEX start, INDEX count) {
     return std::sqrt(result);
 }
 
-template <VectorLike A>
+template <AnyVectorLike A>
 auto l2(const A& a) {
-    auto n = len(a);
-    return l2(a, static_cast<decltype(n)>(0), n);
+    if constexpr (SparseVectorLike<A>) {
+        return sparse_l2(nonzeros(a));
+    } else {
+        auto n = len(a);
+        return l2(a, static_cast<decltype(n)>(0), n);
+    }
 }
 
 template <VectorLike A, VectorLike B, typename INDEX>
@@ -295,13 +548,18 @@ auto cosine_similarity(const A& a, const B& b, INDEX begin, INDEX count) {
     return dot_product / (l2_a * l2_b);
 }
 
-template <VectorLike A, VectorLike B>
+template <AnyVectorLike A, AnyVectorLike B>
 auto cosine_similarity(const A& a, const B& b) {
-    auto n = len(a);
-    if (n != len(b)) {
-        throw std::length_error("Arrays must have the same length.");
+    if constexpr (SparseVectorLike<A> || SparseVectorLike<B>) {
+        auto dot_product = dot(a, b);
+        return dot_product / (l2(a) * l2(b));
+    } else {
+        auto n = len(a);
+        if (n != len(b)) {
+            throw std::length_error("Arrays must have the same length.");
+        }
+        return cosine_similarity(a, b, static_cast<decltype(n)>(0), n);
     }
-    return cosine_similarity(a, b, static_cast<decltype(n)>(0), n);
 }
 
 template <VectorLike A, VectorLike B, typename INDEX>
@@ -318,13 +576,21 @@ auto euclidean_distance(const A& a, const B& b, INDEX begin, INDEX count) {
     return std::sqrt(result);
 }
 
-template <VectorLike A, VectorLike B>
+template <AnyVectorLike A, AnyVectorLike B>
 auto euclidean_distance(const A& a, const B& b) {
-    auto n = len(a);
-    if (n != len(b)) {
-        throw std::length_error("Arrays must have the same length.");
+    if constexpr (SparseVectorLike<A> && SparseVectorLike<B>) {
+        return sparse_euclidean_distance(nonzeros(a), nonzeros(b));
+    } else if constexpr (SparseVectorLike<A>) {
+        return sparse_dense_euclidean_distance(nonzeros(a), b);
+    } else if constexpr (SparseVectorLike<B>) {
+        return sparse_dense_euclidean_distance(nonzeros(b), a);
+    } else {
+        auto n = len(a);
+        if (n != len(b)) {
+            throw std::length_error("Arrays must have the same length.");
+        }
+        return euclidean_distance(a, b, static_cast<decltype(n)>(0), n);
     }
-    return euclidean_distance(a, b, static_cast<decltype(n)>(0), n);
 }
 
 template <VectorLike A, VectorLike INDEX>
@@ -366,6 +632,536 @@ auto median(A& a) {
     return median(a, static_cast<decltype(n)>(0), n);
 }
 
+// Precomputed tables for a radix-2 real-input FFT of length `size`. The real
+// signal is packed into a complex signal of half the length, so the bit-reversal
+// table and butterfly twiddles are sized for `size / 2`.
+template <typename T>
+struct fft_plan {
+    size_t size;
+    std::vector<size_t> bitrev;
+    std::vector<std::complex<T>> twiddles;       // e^{-2*pi*i*k/(size/2)}, k < size/4
+    std::vector<std::complex<T>> real_twiddles;  // e^{-2*pi*i*k/size}, k < size/2
+
+    explicit fft_plan(size_t n) : size(n) {
+        if (n < 2 || !std::has_single_bit(n)) {
+            throw std::invalid_argument("FFT size must be a power of two of at least 2.");
+        }
+        size_t half = n / 2;
+        int bits = std::countr_zero(half);
+        bitrev.resize(half);
+        for (size_t i = 1; i < half; ++i) {
+            bitrev[i] = (bitrev[i >> 1] >> 1) | ((i & 1) << (bits - 1));
+        }
+        constexpr long double two_pi = 2 * std::numbers::pi_v<long double>;
+        twiddles.resize(half / 2);
+        for (size_t k = 0; k < twiddles.size(); ++k) {
+            long double angle = -two_pi * k / half;
+            twiddles[k] = {static_cast<T>(std::cos(angle)), static_cast<T>(std::sin(angle))};
+        }
+        real_twiddles.resize(half);
+        for (size_t k = 0; k < half; ++k) {
+            long double angle = -two_pi * k / n;
+            real_twiddles[k] = {static_cast<T>(std::cos(angle)), static_cast<T>(std::sin(angle))};
+        }
+    }
+};
+
+// Fetch the plan for a given length, building it on first use. Plans are cached per thread.
+template <typename T>
+const fft_plan<T>& get_fft_plan(size_t n) {
+    thread_local std::unordered_map<size_t, fft_plan<T>> cache;
+    auto it = cache.find(n);
+    if (it == cache.end()) {
+        it = cache.emplace(n, fft_plan<T>(n)).first;
+    }
+    return it->second;
+}
+
+// Plain complex product; avoids the NaN/Inf recovery path of `std::complex::operator*`.
+template <typename T>
+std::complex<T> complex_mul(const std::complex<T>& a, const std::complex<T>& b) {
+    return {a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real()};
+}
+
+// In-place iterative radix-2 complex FFT of length `plan.size / 2` (unscaled in both directions).
+template <typename T>
+void fft(const fft_plan<T>& plan, std::vector<std::complex<T>>& z, bool inverse) {
+    size_t m = plan.bitrev.size();
+    for (size_t i = 0; i < m; ++i) {
+        size_t j = plan.bitrev[i];
+        if (i < j) {
+            std::swap(z[i], z[j]);
+        }
+    }
+    for (size_t width = 2; width <= m; width <<= 1) {
+        size_t half = width / 2;
+        size_t stride = m / width;
+        for (size_t i = 0; i < m; i += width) {
+            for (size_t k = 0; k < half; ++k) {
+                auto w = plan.twiddles[k * stride];
+                if (inverse) {
+                    w = std::conj(w);
+                }
+                auto u = z[i + k];
+                auto v = complex_mul(z[i + k + half], w);
+                z[i + k] = u + v;
+                z[i + k + half] = u - v;
+            }
+        }
+    }
+}
+
+// Forward FFT of a real signal of length `plan.size`, returning the `plan.size / 2 + 1`
+// non-redundant bins.
+template <typename T>
+std::vector<std::complex<T>> rfft(const fft_plan<T>& plan, const std::vector<T>& x) {
+    size_t m = plan.size / 2;
+    std::vector<std::complex<T>> z(m);
+    for (size_t j = 0; j < m; ++j) {
+        z[j] = {x[2 * j], x[2 * j + 1]};
+    }
+    fft(plan, z, false);
+
+    std::vector<std::complex<T>> spectrum(m + 1);
+    spectrum[0] = {z[0].real() + z[0].imag(), 0};
+    spectrum[m] = {z[0].real() - z[0].imag(), 0};
+    for (size_t k = 1; k < m; ++k) {
+        auto zc = std::conj(z[m - k]);
+        auto even = (z[k] + zc) * static_cast<T>(0.5);
+        auto odd = complex_mul(z[k] - zc, std::complex<T>(0, -0.5));
+        spectrum[k] = even + complex_mul(plan.real_twiddles[k], odd);
+    }
+    return spectrum;
+}
+
+// Inverse of `rfft`, scaled so that `irfft(plan, rfft(plan, x)) == x`.
+template <typename T>
+std::vector<T> irfft(const fft_plan<T>& plan, const std::vector<std::complex<T>>& spectrum) {
+    size_t m = plan.size / 2;
+    std::vector<std::complex<T>> z(m);
+    for (size_t k = 0; k < m; ++k) {
+        auto xc = std::conj(spectrum[m - k]);
+        auto even = (spectrum[k] + xc) * static_cast<T>(0.5);
+        auto odd = complex_mul((spectrum[k] - xc) * static_cast<T>(0.5), std::conj(plan.real_twiddles[k]));
+        z[k] = even + std::complex<T>(-odd.imag(), odd.real());
+    }
+    fft(plan, z, true);
+
+    std::vector<T> x(plan.size);
+    T scale = static_cast<T>(1) / static_cast<T>(m);
+    for (size_t j = 0; j < m; ++j) {
+        x[2 * j] = z[j].real() * scale;
+        x[2 * j + 1] = z[j].imag() * scale;
+    }
+    return x;
+}
+
+// Direct summation costs about `n * lags` multiply-adds, while the FFT path runs three
+// transforms over the padded length. Prefer the direct loop when it is the cheaper of the two.
+inline bool prefer_direct_correlation(size_t n, size_t lags, size_t padded) {
+    return n * lags <= 4 * padded * static_cast<size_t>(std::bit_width(padded));
+}
+
+// Unnormalized lagged products sum_t a[t] * b[t + k] for k in [-max_lag, max_lag], stored at
+// index `max_lag + k`. When `a` and `b` are the same vector only k >= 0 is filled in.
+template <typename T>
+std::vector<T> lagged_products(const std::vector<T>& a, const std::vector<T>& b, size_t max_lag) {
+    size_t n = a.size();
+    bool same = &a == &b;
+    std::vector<T> result(2 * max_lag + 1, 0);
+    size_t padded = std::max<size_t>(std::bit_ceil(n + max_lag), 2);
+
+    if (prefer_direct_correlation(n, same ? max_lag + 1 : 2 * max_lag + 1, padded)) {
+        for (size_t k = 0; k <= max_lag; ++k) {
+            T acc = 0;
+            for (size_t t = 0; t + k < n; ++t) {
+                acc += a[t] * b[t + k];
+            }
+            result[max_lag + k] = acc;
+            if (!same && k > 0) {
+                acc = 0;
+                for (size_t t = 0; t + k < n; ++t) {
+                    acc += a[t + k] * b[t];
+                }
+                result[max_lag - k] = acc;
+            }
+        }
+        return result;
+    }
+
+    // Zero padding to at least n + max_lag keeps circular wrap-around out of the lags we read.
+    const auto& plan = get_fft_plan<T>(padded);
+    std::vector<T> buffer(padded, 0);
+    std::copy(a.begin(), a.end(), buffer.begin());
+    auto spectrum = rfft(plan, buffer);
+    if (same) {
+        for (auto& bin : spectrum) {
+            bin = {std::norm(bin), 0};
+        }
+    } else {
+        std::fill(buffer.begin(), buffer.end(), static_cast<T>(0));
+        std::copy(b.begin(), b.end(), buffer.begin());
+        auto other = rfft(plan, buffer);
+        for (size_t k = 0; k < spectrum.size(); ++k) {
+            spectrum[k] = complex_mul(std::conj(spectrum[k]), other[k]);
+        }
+    }
+    auto circular = irfft(plan, spectrum);
+    for (size_t k = 0; k <= max_lag; ++k) {
+        result[max_lag + k] = circular[k];
+        if (!same && k > 0) {
+            result[max_lag - k] = circular[padded - k];
+        }
+    }
+    return result;
+}
+
+// Copy an Array-like type into a contiguous buffer with its mean removed
+template <typename T, VectorLike A>
+std::vector<T> demeaned(const A& a) {
+    size_t n = len(a);
+    std::vector<T> result(n);
+    T total = 0;
+    for (size_t i = 0; i < n; ++i) {
+        result[i] = static_cast<T>(at(a, i));
+        total += result[i];
+    }
+    T m = total / static_cast<T>(n);
+    for (auto& value : result) {
+        value -= m;
+    }
+    return result;
+}
+
+// Define the autocorrelation function for an Array-like type. Returns the sample ACF for
+// lags 0 through `max_lag`, normalized so that lag 0 is 1.
+template <VectorLike A>
+auto autocorrelation(const A& a, size_t max_lag) {
+    using ValueType = std::remove_reference_t<decltype(at(a, 0))>;
+    using SumType = std::common_type_t<ValueType, double>;
+
+    size_t n = len(a);
+    if (n < 2) {
+        throw std::invalid_argument("Autocorrelation requires at least 2 elements.");
+    }
+    if (max_lag >= n) {
+        throw std::invalid_argument("Lag must be smaller than the series length.");
+    }
+
+    auto x = demeaned<SumType>(a);
+    auto products = lagged_products(x, x, max_lag);
+    std::vector<SumType> result(products.begin() + max_lag, products.end());
+    SumType c0 = result[0];
+    for (auto& value : result) {
+        value /= c0;
+    }
+    return result;
+}
+
+// Define the cross-correlation function for two Array-like types. Returns `2 * max_lag + 1`
+// values; entry `max_lag + k` correlates a[t] with b[t + k], so lag 0 is the Pearson correlation.
+template <VectorLike A, VectorLike B>
+auto cross_correlation(const A& a, const B& b, size_t max_lag) {
+    using ValueTypeA = std::remove_reference_t<decltype(at(a, 0))>;
+    using ValueTypeB = std::remove_reference_t<decltype(at(b, 0))>;
+    using SumType = std::common_type_t<ValueTypeA, ValueTypeB, double>;
+
+    size_t n = len(a);
+    if (n != static_cast<size_t>(len(b))) {
+        throw std::length_error("Arrays must have the same length.");
+    }
+    if (n < 2) {
+        throw std::invalid_argument("Cross-correlation requires at least 2 elements.");
+    }
+    if (max_lag >= n) {
+        throw std::invalid_argument("Lag must be smaller than the series length.");
+    }
+
+    auto x = demeaned<SumType>(a);
+    auto y = demeaned<SumType>(b);
+    SumType xx = 0;
+    SumType yy = 0;
+    for (size_t i = 0; i < n; ++i) {
+        xx += x[i] * x[i];
+        yy += y[i] * y[i];
+    }
+    auto result = lagged_products(x, y, max_lag);
+    SumType norm = std::sqrt(xx * yy);
+    for (auto& value : result) {
+        value /= norm;
+    }
+    return result;
+}
+
+// Map a value to an unsigned key whose integer order matches the value order. IEEE floats
+// have the sign bit set on positives and every bit flipped on negatives; signed integers
+// have the sign bit flipped. Only float, double and integer types have such a key.
+template <typename T>
+concept RadixSortable = std::is_same_v<T, float> || std::is_same_v<T, double> || std::is_integral_v<T>;
+
+template <RadixSortable T>
+uint64_t radix_key(T value) {
+    if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>) {
+        using Bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+        constexpr Bits sign = Bits(1) << (sizeof(Bits) * 8 - 1);
+        if (value == 0) {
+            value = 0;  // Fold -0.0 into +0.0 so the two tie.
+        }
+        Bits bits = std::bit_cast<Bits>(value);
+        return (bits & sign) ? static_cast<Bits>(~bits) : static_cast<Bits>(bits | sign);
+    } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+        using Bits = std::make_unsigned_t<T>;
+        constexpr Bits sign = static_cast<Bits>(Bits(1) << (sizeof(Bits) * 8 - 1));
+        return static_cast<Bits>(static_cast<Bits>(value) ^ sign);
+    } else {
+        return value;
+    }
+}
+
+// Fill `keys` with order-preserving keys for an Array-like type. Values without a radix key
+// (e.g. long double) are ordered with a comparison sort and keyed by their dense rank, so
+// distinct values are never rounded into ties.
+template <VectorLike A>
+void rank_keys(const A& a, std::vector<uint64_t>& keys, std::vector<size_t>& order) {
+    using ValueType = std::remove_reference_t<decltype(at(a, 0))>;
+
+    size_t n = len(a);
+    keys.resize(n);
+    if constexpr (RadixSortable<ValueType>) {
+        for (size_t i = 0; i < n; ++i) {
+            keys[i] = radix_key(at(a, i));
+        }
+    } else {
+        std::vector<ValueType> values(n);
+        order.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            values[i] = at(a, i);
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(), [&](size_t x, size_t y) { return values[x] < values[y]; });
+        uint64_t key = 0;
+        for (size_t i = 0; i < n; ++i) {
+            if (i > 0 && values[order[i - 1]] < values[order[i]]) {
+                ++key;
+            }
+            keys[order[i]] = key;
+        }
+    }
+}
+
+// Reusable buffers for the rank functions. Passing the same workspace to repeated calls
+// avoids reallocating on every call.
+struct rank_workspace {
+    std::vector<uint64_t> keys_a;
+    std::vector<uint64_t> keys_b;
+    std::vector<uint64_t> keys;
+    std::vector<uint64_t> keys_buffer;
+    std::vector<size_t> order;
+    std::vector<size_t> order_buffer;
+};
+
+// Stable LSD radix sort of `ws.keys`, carrying `ws.order` along, one byte per pass. The
+// histograms for every digit are built in a single sweep, and passes where all keys share
+// the digit are skipped, so narrow types only pay for the bytes they use.
+inline void radix_sort(rank_workspace& ws) {
+    size_t n = ws.keys.size();
+    if (n < 2) {
+        return;
+    }
+    std::array<std::array<size_t, 256>, 8> counts{};
+    for (auto key : ws.keys) {
+        for (size_t d = 0; d < 8; ++d) {
+            ++counts[d][(key >> (8 * d)) & 0xFF];
+        }
+    }
+    ws.keys_buffer.resize(n);
+    ws.order_buffer.resize(n);
+    for (size_t d = 0; d < 8; ++d) {
+        size_t shift = 8 * d;
+        auto& count = counts[d];
+        if (count[(ws.keys[0] >> shift) & 0xFF] == n) {
+            continue;
+        }
+        size_t offset = 0;
+        for (auto& c : count) {
+            size_t bucket = c;
+            c = offset;
+            offset += bucket;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            size_t slot = count[(ws.keys[i] >> shift) & 0xFF]++;
+            ws.keys_buffer[slot] = ws.keys[i];
+            ws.order_buffer[slot] = ws.order[i];
+        }
+        ws.keys.swap(ws.keys_buffer);
+        ws.order.swap(ws.order_buffer);
+    }
+}
+
+// Number of tied pairs in a sorted key sequence, i.e. the sum of t * (t - 1) / 2 over runs.
+inline uint64_t tied_pairs(const std::vector<uint64_t>& sorted) {
+    uint64_t result = 0;
+    uint64_t run = 1;
+    for (size_t i = 1; i < sorted.size(); ++i) {
+        if (sorted[i] == sorted[i - 1]) {
+            result += run++;
+        } else {
+            run = 1;
+        }
+    }
+    return result;
+}
+
+// Bottom-up merge sort of `keys` that returns the number of strictly inverted pairs.
+inline uint64_t count_inversions(std::vector<uint64_t>& keys, std::vector<uint64_t>& buffer) {
+    size_t n = keys.size();
+    buffer.resize(n);
+    uint64_t swaps = 0;
+    for (size_t width = 1; width < n; width *= 2) {
+        for (size_t lo = 0; lo < n; lo += 2 * width) {
+            size_t mid = std::min(lo + width, n);
+            size_t hi = std::min(lo + 2 * width, n);
+            size_t i = lo;
+            size_t j = mid;
+            size_t k = lo;
+            while (i < mid && j < hi) {
+                if (keys[j] < keys[i]) {
+                    swaps += mid - i;
+                    buffer[k++] = keys[j++];
+                } else {
+                    buffer[k++] = keys[i++];
+                }
+            }
+            k = std::copy(keys.begin() + i, keys.begin() + mid, buffer.begin() + k) - buffer.begin();
+            std::copy(keys.begin() + j, keys.begin() + hi, buffer.begin() + k);
+        }
+        keys.swap(buffer);
+    }
+    return swaps;
+}
+
+// Define the `rank` function for an Array-like type. Returns 1-based ranks; tied values
+// share the average of the ranks they span.
+template <VectorLike A>
+std::vector<double> rank(const A& a, rank_workspace& ws) {
+    size_t n = len(a);
+    rank_keys(a, ws.keys, ws.order_buffer);
+    ws.order.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        ws.order[i] = i;
+    }
+    radix_sort(ws);
+
+    std::vector<double> result(n);
+    for (size_t i = 0; i < n;) {
+        size_t j = i + 1;
+        while (j < n && ws.keys[j] == ws.keys[i]) {
+            ++j;
+        }
+        double average = (i + 1 + j) / 2.0;
+        for (size_t k = i; k < j; ++k) {
+            result[ws.order[k]] = average;
+        }
+        i = j;
+    }
+    return result;
+}
+
+template <VectorLike A>
+std::vector<double> rank(const A& a) {
+    rank_workspace ws;
+    return rank(a, ws);
+}
+
+// Define the Spearman rank correlation for two Array-like types
+template <VectorLike A, VectorLike B>
+auto spearman(const A& a, const B& b, rank_workspace& ws) {
+    size_t n = len(a);
+    if (n != static_cast<size_t>(len(b))) {
+        throw std::length_error("Arrays must have the same length.");
+    }
+    if (n < 2) {
+        throw std::invalid_argument("Spearman correlation requires at least 2 elements.");
+    }
+
+    auto ra = rank(a, ws);
+    auto rb = rank(b, ws);
+    double m = (n + 1) / 2.0;
+    double ab = 0;
+    double aa = 0;
+    double bb = 0;
+    for (size_t i = 0; i < n; ++i) {
+        double da = ra[i] - m;
+        double db = rb[i] - m;
+        ab += da * db;
+        aa += da * da;
+        bb += db * db;
+    }
+    return ab / std::sqrt(aa * bb);
+}
+
+template <VectorLike A, VectorLike B>
+auto spearman(const A& a, const B& b) {
+    rank_workspace ws;
+    return spearman(a, b, ws);
+}
+
+// Define Kendall's tau-b for two Array-like types. Pairs are radix sorted by (a, b), and the
+// discordant pairs are counted as merge sort inversions of b, for O(n log n) overall.
+template <VectorLike A, VectorLike B>
+auto kendall_tau(const A& a, const B& b, rank_workspace& ws) {
+    size_t n = len(a);
+    if (n != static_cast<size_t>(len(b))) {
+        throw std::length_error("Arrays must have the same length.");
+    }
+    if (n < 2) {
+        throw std::invalid_argument("Kendall's tau requires at least 2 elements.");
+    }
+
+    rank_keys(a, ws.keys_a, ws.order_buffer);
+    rank_keys(b, ws.keys_b, ws.order_buffer);
+    ws.order.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        ws.order[i] = i;
+    }
+
+    // Sort by b, then stably by a, which leaves the pairs in lexicographic (a, b) order.
+    ws.keys = ws.keys_b;
+    radix_sort(ws);
+    for (size_t i = 0; i < n; ++i) {
+        ws.keys[i] = ws.keys_a[ws.order[i]];
+    }
+    radix_sort(ws);
+
+    uint64_t ties_a = tied_pairs(ws.keys);
+    uint64_t ties_ab = 0;
+    uint64_t run = 1;
+    for (size_t i = 1; i < n; ++i) {
+        if (ws.keys[i] == ws.keys[i - 1] && ws.keys_b[ws.order[i]] == ws.keys_b[ws.order[i - 1]]) {
+            ties_ab += run++;
+        } else {
+            run = 1;
+        }
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        ws.keys[i] = ws.keys_b[ws.order[i]];
+    }
+    uint64_t swaps = count_inversions(ws.keys, ws.keys_buffer);
+    uint64_t ties_b = tied_pairs(ws.keys);
+
+    uint64_t pairs = static_cast<uint64_t>(n) * (n - 1) / 2;
+    double numerator = static_cast<double>(pairs + ties_ab - ties_a - ties_b) - 2.0 * static_cast<double>(swaps);
+    double denominator = std::sqrt(static_cast<double>(pairs - ties_a) * static_cast<double>(pairs - ties_b));
+    return numerator / denominator;
+}
+
+template <VectorLike A, VectorLike B>
+auto kendall_tau(const A& a, const B& b) {
+    rank_workspace ws;
+    return kendall_tau(a, b, ws);
+}
+
 template <VectorLike A>
 void print(const A& a, std::ostream& os = std::cout) {
     os << "[";
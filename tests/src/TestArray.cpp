@@ -3,7 +3,9 @@
 #include <vector>
 #include <array>
 #include <memory>
+#include <span>
 #include <Eigen/Dense> // Include Eigen
+#include <Eigen/Sparse>
 
 
 class Arr : public ::testing::Test {
@@ -289,4 +291,265 @@ TEST(Arr, JSON) {
     EXPECT_EQ(ums::tojson(j), "[1, 2, 3]");
     EXPECT_EQ(ums::tojson(k), "[1, 2, 3]");
     EXPECT_EQ(ums::tojson(l), "[1, 2, 3]");
-}
\ No newline at end of file
+}
+
+TEST(Arr, Autocorrelation) {
+    std::vector<double> a = {1, 3, 2, 5, 4, 6, 5, 8};
+    std::array<int, 8> b =  {1, 3, 2, 5, 4, 6, 5, 8};
+    Eigen::VectorXd c(8);
+    c << 1, 3, 2, 5, 4, 6, 5, 8;
+
+    std::vector<double> expected = {1.0, 0.24471831, 0.41197183, -0.18133803};
+    for (const auto& acf : {ums::autocorrelation(a, 3), ums::autocorrelation(b, 3), ums::autocorrelation(c, 3)}) {
+        ASSERT_EQ(acf.size(), 4);
+        for (size_t k = 0; k < expected.size(); ++k) {
+            EXPECT_NEAR(acf[k], expected[k], 1e-6);
+        }
+    }
+
+    EXPECT_THROW(ums::autocorrelation(a, 8), std::invalid_argument);
+}
+
+TEST(Arr, AutocorrelationLong) {
+    // Long enough that every lag goes through the FFT path; compare with a direct sum.
+    std::vector<double> a(5000);
+    for (size_t i = 0; i < a.size(); ++i) {
+        a[i] = std::sin(0.01 * i) + 0.3 * std::cos(0.37 * i * i);
+    }
+    size_t max_lag = 1500;
+    auto acf = ums::autocorrelation(a, max_lag);
+
+    double m = ums::mean(a);
+    double c0 = 0;
+    for (double x : a) c0 += (x - m) * (x - m);
+    for (size_t k = 0; k <= max_lag; k += 37) {
+        double ck = 0;
+        for (size_t t = 0; t + k < a.size(); ++t) ck += (a[t] - m) * (a[t + k] - m);
+        EXPECT_NEAR(acf[k], ck / c0, 1e-9);
+    }
+}
+
+TEST(Arr, CrossCorrelation) {
+    std::vector<double> a(3000);
+    std::vector<float> b(3000);
+    for (size_t i = 0; i < a.size(); ++i) {
+        a[i] = std::sin(0.05 * i) + 0.5 * std::cos(0.11 * i * i);
+        b[i] = static_cast<float>(std::cos(0.05 * i) + 0.2 * std::sin(0.7 * i));
+    }
+
+    double ma = ums::mean(a);
+    double mb = ums::mean(b);
+    double aa = 0, bb = 0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        aa += (a[i] - ma) * (a[i] - ma);
+        bb += (b[i] - mb) * (b[i] - mb);
+    }
+    auto reference = [&](long k) {
+        double s = 0;
+        for (long t = 0; t < static_cast<long>(a.size()); ++t) {
+            long u = t + k;
+            if (u >= 0 && u < static_cast<long>(b.size())) s += (a[t] - ma) * (b[u] - mb);
+        }
+        return s / std::sqrt(aa * bb);
+    };
+
+    // Small lag count (direct sum) and large lag count (FFT) must agree with the reference.
+    for (size_t max_lag : {3ul, 1000ul}) {
+        auto xcf = ums::cross_correlation(a, b, max_lag);
+        ASSERT_EQ(xcf.size(), 2 * max_lag + 1);
+        for (long k = -static_cast<long>(max_lag); k <= static_cast<long>(max_lag); k += 1 + max_lag / 20) {
+            EXPECT_NEAR(xcf[max_lag + k], reference(k), 1e-9);
+        }
+    }
+
+    std::vector<double> shorter(10);
+    EXPECT_THROW(ums::cross_correlation(a, shorter, 2), std::length_error);
+}
+
+TEST(Arr, Rank) {
+    std::vector<double> a = {3.5, -1.0, 2.0, -1.0, 0.0, -0.0, 7.25};
+    std::array<int, 7> b =  {30, -10, 20, -10, 0, 0, 70};
+    std::vector<unsigned short> c = {35, 1, 20, 1, 5, 5, 72};
+
+    std::vector<double> expected = {6, 1.5, 5, 1.5, 3.5, 3.5, 7};
+    EXPECT_EQ(ums::rank(a), expected);
+    EXPECT_EQ(ums::rank(b), expected);
+    EXPECT_EQ(ums::rank(c), expected);
+
+    // long double has no radix key; values that differ only beyond double precision must not tie.
+    std::vector<long double> d = {2.0L, 1.0L + 1e-18L, 1.0L, 1.0L};
+    std::vector<double> expected_d = {4, 3, 1.5, 1.5};
+    EXPECT_EQ(ums::rank(d), expected_d);
+    std::vector<int> e = {4, 3, 1, 2};
+    EXPECT_NEAR(ums::kendall_tau(d, e), ums::kendall_tau(expected_d, e), 1e-12);
+}
+
+TEST(Arr, Spearman) {
+    std::vector<double> a = {1, 2, 3, 4, 5};
+    std::vector<int> b =    {5, 6, 7, 8, 7};
+    Eigen::VectorXd c(5);
+    c << 5, 4, 3, 2, 1;
+
+    EXPECT_NEAR(ums::spearman(a, b), 0.82078268166812329, 1e-12);
+    EXPECT_NEAR(ums::spearman(a, c), -1.0, 1e-12);
+    EXPECT_NEAR(ums::spearman(a, a), 1.0, 1e-12);
+    EXPECT_THROW(ums::spearman(a, std::vector<int>(3)), std::length_error);
+}
+
+TEST(Arr, KendallTau) {
+    std::vector<double> a = {1, 2, 3, 4, 5};
+    std::vector<int> b =    {5, 6, 7, 8, 7};
+    EXPECT_NEAR(ums::kendall_tau(a, b), 0.73786478737262184, 1e-12);
+
+    // Compare against the O(n^2) tau-b definition on data with plenty of ties.
+    std::vector<float> x(2000);
+    std::vector<long> y(2000);
+    for (size_t i = 0; i < x.size(); ++i) {
+        x[i] = static_cast<float>(static_cast<int>((i * 7919) % 101) - 50) * 0.5f;
+        y[i] = static_cast<long>((i * 104729) % 37) - static_cast<long>(x[i]) / 4;
+    }
+    double concordant = 0, discordant = 0, ties_x = 0, ties_y = 0;
+    for (size_t i = 0; i < x.size(); ++i) {
+        for (size_t j = i + 1; j < x.size(); ++j) {
+            double dx = x[i] - x[j];
+            double dy = static_cast<double>(y[i] - y[j]);
+            if (dx == 0 && dy == 0) continue;
+            if (dx == 0) ++ties_x;
+            else if (dy == 0) ++ties_y;
+            else if ((dx > 0) == (dy > 0)) ++concordant;
+            else ++discordant;
+        }
+    }
+    double expected = (concordant - discordant) /
+        std::sqrt((concordant + discordant + ties_x) * (concordant + discordant + ties_y));
+
+    ums::rank_workspace ws;
+    EXPECT_NEAR(ums::kendall_tau(x, y, ws), expected, 1e-12);
+    EXPECT_NEAR(ums::kendall_tau(x, y, ws), expected, 1e-12);
+    EXPECT_NEAR(ums::kendall_tau(x, x, ws), 1.0, 1e-12);
+}
+
+struct SparseFeatures {
+    std::vector<int> idx;
+    std::vector<float> val;
+    const std::vector<int>& indices() const { return idx; }
+    const std::vector<float>& values() const { return val; }
+};
+
+struct SparseFeatureSpans {
+    std::vector<int> idx;
+    std::vector<float> val;
+    std::span<const int> indices() const { return idx; }
+    std::span<const float> values() const { return val; }
+};
+
+struct SparseFeatureCopies {
+    std::vector<int> idx;
+    std::vector<float> val;
+    std::vector<int> indices() const { return idx; }
+    std::vector<float> values() const { return val; }
+};
+
+TEST(Arr, SparseDot) {
+    Eigen::SparseVector<double> a(1000000);
+    a.insert(3) = 1.0;
+    a.insert(500) = 2.0;
+    a.insert(999999) = 3.0;
+
+    Eigen::SparseMatrix<double, Eigen::RowMajor> m(2, 1000000);
+    m.insert(0, 7) = 5.0;
+    m.insert(1, 3) = 4.0;
+    m.insert(1, 42) = 9.0;
+    m.insert(1, 999999) = -1.0;
+    m.makeCompressed();
+
+    // Rows of an uncompressed matrix start at their outer index with their own non-zero count.
+    Eigen::SparseMatrix<double, Eigen::RowMajor> u(3, 1000000);
+    u.reserve(Eigen::VectorXi::Constant(3, 4));
+    u.insert(1, 500) = 2.0;
+    u.insert(0, 3) = 7.0;
+    u.insert(1, 3) = 1.0;
+    u.insert(2, 999999) = 5.0;
+
+    std::vector<long> pi = {3, 500, 700};
+    std::vector<double> pv = {2.0, 1.0, 8.0};
+    std::pair<std::span<const long>, std::span<const double>> p(pi, pv);
+
+    SparseFeatures f{{500, 999999}, {0.5f, 2.0f}};
+    SparseFeatureSpans g{{500, 999999}, {0.5f, 2.0f}};
+
+    std::vector<double> dense(1000000, 0.0);
+    dense[3] = 1.0;
+    dense[500] = 1.0;
+    dense[999999] = 1.0;
+
+    EXPECT_EQ(ums::dot(a, a), 14.0);
+    EXPECT_EQ(ums::dot(a, m.row(1)), 1.0);
+    EXPECT_EQ(ums::dot(m.row(1), a), 1.0);
+    EXPECT_EQ(ums::dot(a, p), 4.0);
+    EXPECT_EQ(ums::dot(p, f), 0.5);
+    EXPECT_EQ(ums::dot(a, f), 7.0);
+    EXPECT_EQ(ums::dot(a, dense), 6.0);
+    EXPECT_EQ(ums::dot(dense, p), 3.0);
+    EXPECT_EQ(ums::dot(m.row(0), dense), 0.0);
+    EXPECT_FALSE(u.isCompressed());
+    EXPECT_EQ(ums::dot(u.row(0), a), 7.0);
+    EXPECT_EQ(ums::dot(a, u.row(1)), 5.0);
+    EXPECT_EQ(ums::dot(u.row(2), dense), 5.0);
+    EXPECT_EQ(ums::dot(g, dense), 2.5);
+
+    // Accessors returning containers by value would leave the view dangling.
+    static_assert(ums::SparseVectorLike<SparseFeatureSpans>);
+    static_assert(!ums::SparseVectorLike<SparseFeatureCopies>);
+    // Whole matrices and multi-row blocks are not flattened into a single vector.
+    static_assert(!ums::SparseVectorLike<Eigen::SparseMatrix<double, Eigen::RowMajor>>);
+    static_assert(!ums::SparseVectorLike<decltype(m.middleRows(0, 2))>);
+    static_assert(ums::SparseVectorLike<decltype(m.row(0))>);
+    // Index arrays must hold integers, and value arrays numbers.
+    static_assert(!ums::SparseVectorLike<std::pair<std::vector<double>, std::vector<double>>>);
+    static_assert(!ums::SparseVectorLike<std::pair<std::string, std::string>>);
+
+    EXPECT_THROW(ums::dot(a, std::vector<double>(10)), std::length_error);
+    EXPECT_THROW(ums::dot(p, std::vector<double>(600)), std::out_of_range);
+
+    std::vector<int> ni = {-1, 4};
+    std::vector<double> nv = {1.0, 2.0};
+    std::pair<std::span<const int>, std::span<const double>> negative(ni, nv);
+    Eigen::VectorXd ed = Eigen::VectorXd::Ones(10);
+    EXPECT_THROW(ums::dot(negative, std::vector<double>(10)), std::out_of_range);
+    EXPECT_THROW(ums::dot(negative, ed), std::out_of_range);
+    EXPECT_THROW(ums::dot(negative, p), std::out_of_range);
+}
+
+TEST(Arr, SparseGalloping) {
+    // One side is far shorter than the other, so the intersection gallops.
+    std::vector<int> li, si = {0, 17, 18, 5000, 99999};
+    std::vector<double> lv, sv = {1, 2, 3, 4, 5};
+    for (int i = 0; i < 100000; i += 3) {
+        li.push_back(i);
+        lv.push_back(i);
+    }
+    std::pair<std::span<const int>, std::span<const double>> large(li, lv), small(si, sv);
+
+    double expected = 0 * 1 + 18 * 3 + 99999 * 5;
+    EXPECT_EQ(ums::dot(small, large), expected);
+    EXPECT_EQ(ums::dot(large, small), expected);
+}
+
+TEST(Arr, SparseNorms) {
+    Eigen::SparseVector<double> a(10);
+    a.insert(1) = 3.0;
+    a.insert(4) = 4.0;
+    std::vector<int> bi = {4, 9};
+    std::vector<double> bv = {4.0, 12.0};
+    std::pair<std::vector<int>, std::vector<double>> b(bi, bv);
+    std::array<double, 10> dense = {0, 3, 0, 0, 4, 0, 0, 0, 0, 0};
+
+    EXPECT_NEAR(ums::l2(a), 5.0, 1e-12);
+    EXPECT_NEAR(ums::l2(b), std::sqrt(160.0), 1e-12);
+    EXPECT_NEAR(ums::cosine_similarity(a, dense), 1.0, 1e-12);
+    EXPECT_NEAR(ums::cosine_similarity(a, b), 16.0 / (5.0 * std::sqrt(160.0)), 1e-12);
+    EXPECT_NEAR(ums::euclidean_distance(a, b), std::sqrt(9.0 + 144.0), 1e-12);
+    EXPECT_NEAR(ums::euclidean_distance(a, dense), 0.0, 1e-12);
+    EXPECT_NEAR(ums::euclidean_distance(dense, b), std::sqrt(9.0 + 144.0), 1e-12);
+}